@@ -7,9 +7,13 @@
 long long calculateTotalCompletionTime(const std::vector<Task>& tasks,
                                        const std::vector<int>& order);
 
+// The overloads taking an output argument reuse its capacity; with a warm
+// per-thread scratch arena they solve without heap allocations.
 std::vector<int> sptOrder(const std::vector<Task>& tasks, int threads);
+void sptOrder(const std::vector<Task>& tasks, int threads, std::vector<int>& order);
 
 std::vector<int> cheapestInsertionOrder(const std::vector<Task>& tasks, int threads);
+void cheapestInsertionOrder(const std::vector<Task>& tasks, int threads, std::vector<int>& order);
 
 struct LsParams {
     int maxNoImproveTries = 1000;
@@ -24,3 +28,35 @@ struct LsResult {
 
 LsResult localSearch2Swap(const std::vector<Task>& tasks,
                           const LsParams& params, int threads);
+void localSearch2Swap(const std::vector<Task>& tasks,
+                      const LsParams& params, int threads, LsResult& result);
+
+struct GaParams {
+    int populationSize = 64;
+    int offspringPerGeneration = 32;   // evaluated together as one batch
+    double mutationRate = 0.3;         // probability of a swap mutation per child
+    int eliteCount = 2;                // best individuals polished by 2-swap LS
+    int polishEvery = 0;               // generations between polishes, 0 = off
+    int maxGenerations = 0;            // 0 = run until the time budget
+    int timeBudgetMs = 2000;
+    unsigned int seed = 42;
+};
+
+struct GaProgress {
+    long long timeMs = 0;
+    long long generation = 0;
+    long long bestSumC = 0;
+};
+
+struct GaResult {
+    std::vector<int> order;
+    long long sumC = 0;
+    long long generations = 0;
+    double generationsPerSec = 0.0;
+    std::vector<GaProgress> history;   // one entry per improvement of the best ΣCi
+};
+
+GaResult geneticOrder(const std::vector<Task>& tasks,
+                      const GaParams& params, int threads);
+void geneticOrder(const std::vector<Task>& tasks,
+                  const GaParams& params, int threads, GaResult& result);
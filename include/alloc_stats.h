@@ -0,0 +1,33 @@
+#ifndef ZSSK_ALLOC_STATS_H
+#define ZSSK_ALLOC_STATS_H
+
+#pragma once
+#include <cstdint>
+
+// ======================================================
+// Heap allocation accounting via a replaced global operator new.
+// Enabled by the ZSSK_ALLOC_STATS CMake option; otherwise every count is 0
+// and allocationStatsEnabled() returns false.
+// ======================================================
+bool allocationStatsEnabled();
+
+// operator new calls since start, all threads; sums the per-thread
+// counters under a lock, so call it around a measurement, not inside one
+std::uint64_t allocationCount();
+
+// operator new calls made by the calling thread
+std::uint64_t threadAllocationCount();
+
+// Counts allocations between construction and allocations()
+class AllocationProbe {
+public:
+    AllocationProbe() : startAll(allocationCount()), startThread(threadAllocationCount()) {}
+    std::uint64_t allocations() const { return allocationCount() - startAll; }
+    std::uint64_t threadAllocations() const { return threadAllocationCount() - startThread; }
+
+private:
+    std::uint64_t startAll;
+    std::uint64_t startThread;
+};
+
+#endif // ZSSK_ALLOC_STATS_H
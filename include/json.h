@@ -0,0 +1,39 @@
+#ifndef ZSSK_JSON_H
+#define ZSSK_JSON_H
+
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+
+// Minimal JSON document model, enough for the JSON-lines solve protocol
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string str;
+    std::vector<JsonValue> items;                              // Array
+    std::vector<std::pair<std::string, JsonValue>> fields;     // Object (in input order)
+
+    bool isNull() const { return type == Type::Null; }
+    bool isNumber() const { return type == Type::Number; }
+    bool isString() const { return type == Type::String; }
+    bool isArray() const { return type == Type::Array; }
+    bool isObject() const { return type == Type::Object; }
+
+    // Object member lookup; nullptr if missing or not an object
+    const JsonValue* find(const std::string& key) const;
+};
+
+// Parses one complete JSON document; on failure returns false and fills error
+bool parseJson(const std::string& text, JsonValue& out, std::string& error);
+
+// Serializes a value back to compact JSON
+std::string toJson(const JsonValue& value);
+
+// Quotes and escapes a string for embedding in JSON output
+std::string jsonQuote(const std::string& s);
+
+#endif // ZSSK_JSON_H
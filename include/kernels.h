@@ -0,0 +1,486 @@
+#ifndef ZSSK_KERNELS_H
+#define ZSSK_KERNELS_H
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <random>
+#include <new>
+#include "scheduler.h"
+#include "algorithms.h"
+#include "scratch.h"
+#include "worker_pool.h"
+
+// ======================================================
+// Algorithm kernels, specialized at compile time on:
+//   Objective - scoring rule (ΣCi today), provides O(1) move deltas
+//   Policy    - Sequential / Parallel execution
+//   Index     - width of the order buffer (std::uint32_t / std::size_t)
+// The functions in algorithms.h are thin instantiations of these.
+//
+// Working buffers come from the calling thread's ScratchArena and parallel
+// rounds run on its WorkerPool, so a warmed-up kernel does not touch the heap.
+// ======================================================
+namespace kernels {
+
+// ------------------------------------------------------
+// Objective: total completion time ΣCi
+// A job at position k of an n-job sequence contributes p * (n - k).
+// ------------------------------------------------------
+struct TotalCompletionTime {
+    // Dispatch key that is optimal for the objective, smaller first (SPT for ΣCi)
+    static int priority(int p) { return p; }
+
+    template <class Index>
+    static long long evaluate(const std::vector<Task>& tasks, const Index* order, std::size_t n) {
+        long long sum = 0;
+        long long current = 0;
+        for (std::size_t k = 0; k < n; ++k) {
+            current += tasks[order[k]].p;
+            sum += current;
+        }
+        return sum;
+    }
+
+    // Durations already laid out in sequence order (contiguous, vectorizable)
+    static long long evaluateSequence(const int* seqP, std::size_t n) {
+        long long sum = 0;
+        for (std::size_t k = 0; k < n; ++k)
+            sum += (long long)seqP[k] * (long long)(n - k);
+        return sum;
+    }
+
+    // Change of the objective after swapping positions i < j holding durations a, b
+    static long long swapDelta(long long a, long long b, std::size_t i, std::size_t j) {
+        return (b - a) * (long long)(j - i);
+    }
+
+    // Increase of the objective when a job of duration pt is inserted at pos
+    // into a sequence of length len; prefix = sum of durations before pos
+    static long long insertionCost(long long prefix, long long pt, std::size_t pos, std::size_t len) {
+        return prefix + pt * (long long)(len - pos + 1);
+    }
+};
+
+// ------------------------------------------------------
+// Execution policies
+// ------------------------------------------------------
+struct Sequential { static constexpr bool parallel = false; };
+struct Parallel   { static constexpr bool parallel = true;  };
+
+// Below these sizes the parallel variants cost more than they save
+inline constexpr std::size_t kParallelScanGrain = 1u << 15;
+inline constexpr std::size_t kParallelSortGrain = 1u << 14;
+
+// Upper bound on GaResult::history entries (the list is reused between runs)
+inline constexpr std::size_t kGaHistoryCapacity = 1024;
+
+template <class Policy>
+int workerCount(int threads) {
+    return Policy::parallel ? std::max(1, threads) : 1;
+}
+
+// ======================================================
+// Priority dispatch (SPT for ΣCi)
+// ======================================================
+
+// Narrow indices pack (key, index) into one 64-bit word so the sort compares
+// plain integers; the sign bit is flipped so signed keys order as unsigned.
+// Wide indices sort (key, index) pairs. Either way ties go to the lower index.
+template <class Index, bool Narrow = (sizeof(Index) <= sizeof(std::uint32_t))>
+struct PriorityKey {
+    using Type = std::uint64_t;
+    static Type make(int key, std::size_t i) {
+        return ((std::uint64_t)((std::uint32_t)key ^ 0x80000000u) << 32) | (std::uint64_t)i;
+    }
+    static Index index(Type k) { return (Index)(k & 0xFFFFFFFFu); }
+};
+
+template <class Index>
+struct PriorityKey<Index, false> {
+    struct Type {
+        int key;
+        Index idx;
+        bool operator<(const Type& o) const { return key != o.key ? key < o.key : idx < o.idx; }
+    };
+    static Type make(int key, std::size_t i) { return {key, (Index)i}; }
+    static Index index(const Type& k) { return k.idx; }
+};
+
+// Sorts chunks on the worker pool, then merges pairs of runs between
+// keys and tmp until one run is left
+template <class Key>
+void sortKeys(Key* keys, Key* tmp, std::size_t n, int workers)
+{
+    if (workers <= 1 || n < kParallelSortGrain) {
+        std::sort(keys, keys + n);
+        return;
+    }
+
+    const std::size_t chunks = (std::size_t)workers;
+    auto bound = [&](std::size_t c) { return n * std::min(c, chunks) / chunks; };
+    WorkerPool& pool = WorkerPool::local();
+
+    pool.run(workers, [&](int w) { std::sort(keys + bound(w), keys + bound(w + 1)); });
+
+    Key* src = keys;
+    Key* dst = tmp;
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        pool.run((int)pairs, [&](int pi) {
+            std::size_t c = (std::size_t)pi * 2 * width;
+            std::size_t lo = bound(c), mid = bound(c + width), hi = bound(c + 2 * width);
+            std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo);
+        });
+        std::swap(src, dst);
+    }
+    if (src != keys) std::copy_n(src, n, keys);
+}
+
+template <class Objective, class Policy, class Index>
+void priorityOrder(const std::vector<Task>& tasks, int threads, Index* order)
+{
+    using PK = PriorityKey<Index>;
+    using Key = typename PK::Type;
+    const std::size_t n = tasks.size();
+    const int workers = workerCount<Policy>(threads);
+
+    ScratchArena& arena = ScratchArena::local();
+    ScratchScope scope(arena);
+    Key* keys = arena.take<Key>(n);
+    Key* tmp = workers > 1 ? arena.take<Key>(n) : nullptr;
+
+    for (std::size_t i = 0; i < n; ++i)
+        keys[i] = PK::make(Objective::priority(tasks[i].p), i);
+    sortKeys(keys, tmp, n, workers);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = PK::index(keys[i]);
+}
+
+// ======================================================
+// Cheapest insertion
+// Jobs are taken in priority order; each one goes to the position with the
+// smallest objective increase (first such position on ties).
+// ======================================================
+struct InsertionProbe {
+    long long cost = LLONG_MAX;   // best cost relative to the start of the range
+    std::size_t pos = 0;
+    long long rangeSum = 0;       // sum of durations in the range
+};
+
+template <class Objective>
+InsertionProbe scanInsertion(const int* seqP, std::size_t from, std::size_t to,
+                             long long pt, std::size_t len)
+{
+    // Positions [from, to]; seqP[pos] is the job currently at pos
+    InsertionProbe probe;
+    long long prefix = 0;
+    for (std::size_t pos = from; pos <= to; ++pos) {
+        long long cost = Objective::insertionCost(prefix, pt, pos, len);
+        if (cost < probe.cost) {
+            probe.cost = cost;
+            probe.pos = pos;
+        }
+        if (pos < to) prefix += seqP[pos];
+    }
+    probe.rangeSum = prefix;
+    return probe;
+}
+
+template <class Objective, class Policy, class Index>
+void cheapestInsertion(const std::vector<Task>& tasks, int threads, Index* order)
+{
+    const std::size_t n = tasks.size();
+    if (n == 0) return;
+    const int workers = workerCount<Policy>(threads);
+
+    ScratchArena& arena = ScratchArena::local();
+    ScratchScope scope(arena);
+    Index* indices = arena.take<Index>(n);
+    int* seqP = arena.take<int>(n);   // durations in the same order, scanned contiguously
+    InsertionProbe* probes = arena.take<InsertionProbe>(workers);
+
+    priorityOrder<Objective, Sequential, Index>(tasks, 1, indices);
+
+    std::size_t len = 0;
+    for (; len < std::min<std::size_t>(2, n); ++len) {
+        order[len] = indices[len];
+        seqP[len] = tasks[indices[len]].p;
+    }
+
+    for (std::size_t i = 2; i < n; ++i) {
+        Index t = indices[i];
+        long long pt = tasks[t].p;
+        std::size_t bestPos = 0;
+
+        if (workers > 1 && len >= kParallelScanGrain) {
+            // Each chunk is scanned with a local prefix; the argmin of a chunk does
+            // not depend on the offset, so chunks are combined afterwards.
+            std::size_t chunk = (len + 1 + workers - 1) / workers;
+            WorkerPool::local().run(workers, [&](int th) {
+                std::size_t from = th * chunk;
+                if (from > len) { probes[th] = InsertionProbe{}; return; }
+                std::size_t to = std::min(len, from + chunk - 1);
+                probes[th] = scanInsertion<Objective>(seqP, from, to, pt, len);
+                if (to < len) probes[th].rangeSum += seqP[to];
+            });
+
+            long long offset = 0;
+            long long bestCost = LLONG_MAX;
+            for (int th = 0; th < workers; ++th) {
+                if (probes[th].cost != LLONG_MAX && offset + probes[th].cost < bestCost) {
+                    bestCost = offset + probes[th].cost;
+                    bestPos = probes[th].pos;
+                }
+                offset += probes[th].rangeSum;
+            }
+        } else {
+            bestPos = scanInsertion<Objective>(seqP, 0, len, pt, len).pos;
+        }
+
+        std::copy_backward(order + bestPos, order + len, order + len + 1);
+        std::copy_backward(seqP + bestPos, seqP + len, seqP + len + 1);
+        order[bestPos] = t;
+        seqP[bestPos] = (int)pt;
+        ++len;
+    }
+}
+
+// ======================================================
+// First-improvement 2-swap descent on one sequence, in place.
+// Stops at a local optimum or at the deadline; returns the objective change.
+// ======================================================
+template <class Objective, class Index>
+long long improve2Swap(Index* order, int* seqP, std::size_t n,
+                       std::chrono::steady_clock::time_point deadline)
+{
+    long long total = 0;
+    bool improved = true;
+    bool expired = false;
+    while (improved && !expired) {
+        improved = false;
+        for (std::size_t i = 0; i + 1 < n && !expired; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                long long d = Objective::swapDelta(seqP[i], seqP[j], i, j);
+                if (d < 0) {
+                    std::swap(order[i], order[j]);
+                    std::swap(seqP[i], seqP[j]);
+                    total += d;
+                    improved = true;
+                }
+            }
+            expired = std::chrono::steady_clock::now() > deadline;
+        }
+    }
+    return total;
+}
+
+// ======================================================
+// Local search over 2-swap moves, starting from a random permutation;
+// first improvement, applied immediately.
+// Sequential only: each accepted swap changes the deltas of every later
+// pair, and splitting the sequence into blocks still needs cross-block
+// passes that cost as much as the sequential descent, so extra threads
+// cannot beat one. threads > 1 runs this same kernel.
+// ======================================================
+template <class Objective, class Index>
+void localSearch2Swap(const std::vector<Task>& tasks, const LsParams& params, LsResult& res)
+{
+    using clock = std::chrono::steady_clock;
+    const std::size_t n = tasks.size();
+    res.order.clear();
+    res.sumC = 0;
+    if (n == 0) return;
+
+    ScratchArena& arena = ScratchArena::local();
+    ScratchScope scope(arena);
+    Index* order = arena.take<Index>(n);
+    int* seqP = arena.take<int>(n);
+
+    std::iota(order, order + n, Index{0});
+    std::mt19937 gen(params.seed);
+    std::shuffle(order, order + n, gen);
+    for (std::size_t k = 0; k < n; ++k) seqP[k] = tasks[order[k]].p;
+
+    long long sum = Objective::evaluateSequence(seqP, n);
+    const auto deadline = clock::now() + std::chrono::milliseconds(params.timeBudgetMs);
+
+    sum += improve2Swap<Objective>(order, seqP, n, deadline);
+
+    res.order.assign(order, order + n);
+    res.sumC = sum;
+}
+
+// ======================================================
+// Batched fitness: rows of durations in sequence order, one row per individual
+// ======================================================
+template <class Objective>
+void evaluateBatch(const int* seqP, std::size_t rows, std::size_t n, long long* out)
+{
+    for (std::size_t r = 0; r < rows; ++r)
+        out[r] = Objective::evaluateSequence(seqP + r * n, n);
+}
+
+// ======================================================
+// Steady-state genetic / memetic search
+// The population lives in one arena (row r = individual r) next to a
+// matching arena of durations, so fitness is a contiguous dot product.
+// Each generation breeds a batch of children (tournament selection, order
+// crossover, swap mutation), split across the workers, then replaces the
+// worst individuals. Elites can be polished with improve2Swap.
+// ======================================================
+template <class Objective, class Policy, class Index>
+void genetic(const std::vector<Task>& tasks, const GaParams& params, int threads, GaResult& res)
+{
+    using clock = std::chrono::steady_clock;
+    const std::size_t n = tasks.size();
+    res.order.clear();
+    res.sumC = 0;
+    res.generations = 0;
+    res.generationsPerSec = 0.0;
+    res.history.clear();
+    if (n == 0) return;
+    res.history.reserve(kGaHistoryCapacity);
+
+    const std::size_t pop = (std::size_t)std::max(2, params.populationSize);
+    const std::size_t batch = (std::size_t)std::max(1, params.offspringPerGeneration);
+    const std::size_t elites = std::min(pop, (std::size_t)std::max(0, params.eliteCount));
+    const int workers = workerCount<Policy>(threads);
+
+    ScratchArena& arena = ScratchArena::local();
+    ScratchScope scope(arena);
+    Index* genes = arena.take<Index>(pop * n);
+    Index* childGenes = arena.take<Index>(batch * n);
+    int* durs = arena.take<int>(pop * n);
+    int* childDurs = arena.take<int>(batch * n);
+    long long* fit = arena.take<long long>(pop);
+    long long* childFit = arena.take<long long>(batch);
+    std::size_t* rank = arena.take<std::size_t>(pop);
+
+    auto fillDurations = [&](const Index* row, int* out) {
+        for (std::size_t k = 0; k < n; ++k) out[k] = tasks[row[k]].p;
+    };
+
+    std::mt19937 gen(params.seed);
+    for (std::size_t r = 0; r < pop; ++r) {
+        Index* row = genes + r * n;
+        std::iota(row, row + n, Index{0});
+        std::shuffle(row, row + n, gen);
+        fillDurations(row, durs + r * n);
+    }
+    evaluateBatch<Objective>(durs, pop, n, fit);
+
+    // Per worker: RNG, and gene -> stamp of the child currently holding it
+    std::mt19937* rngs = arena.take<std::mt19937>(workers);
+    std::uint32_t* seen = arena.take<std::uint32_t>(workers * n);
+    std::uint32_t* stamps = arena.take<std::uint32_t>(workers);
+    for (int w = 0; w < workers; ++w) {
+        new (&rngs[w]) std::mt19937(gen());
+        stamps[w] = 0;
+    }
+    std::fill(seen, seen + workers * n, 0u);
+
+    auto tournament = [&](std::mt19937& rng) {
+        std::uniform_int_distribution<std::size_t> pick(0, pop - 1);
+        std::size_t a = pick(rng), b = pick(rng);
+        return fit[a] <= fit[b] ? a : b;
+    };
+
+    auto breed = [&](std::size_t c, int w) {
+        std::mt19937& rng = rngs[w];
+        std::uint32_t* mark = seen + w * n;
+        const Index* p1 = genes + tournament(rng) * n;
+        const Index* p2 = genes + tournament(rng) * n;
+        Index* child = childGenes + c * n;
+
+        if (++stamps[w] == 0) {
+            std::fill(mark, mark + n, 0u);
+            stamps[w] = 1;
+        }
+        const std::uint32_t stamp = stamps[w];
+
+        // Order crossover: keep p1[a..b], fill the rest in p2's order after b
+        std::uniform_int_distribution<std::size_t> cut(0, n - 1);
+        std::size_t a = cut(rng), b = cut(rng);
+        if (a > b) std::swap(a, b);
+        for (std::size_t k = a; k <= b; ++k) {
+            child[k] = p1[k];
+            mark[p1[k]] = stamp;
+        }
+        std::size_t pos = (b + 1) % n;
+        for (std::size_t k = 0; k < n; ++k) {
+            Index g = p2[(b + 1 + k) % n];
+            if (mark[g] == stamp) continue;
+            child[pos] = g;
+            pos = (pos + 1) % n;
+        }
+
+        if (std::uniform_real_distribution<>(0.0, 1.0)(rng) < params.mutationRate)
+            std::swap(child[cut(rng)], child[cut(rng)]);
+
+        fillDurations(child, childDurs + c * n);
+    };
+
+    auto breedSlice = [&](int w) {
+        const std::size_t lo = batch * w / workers;
+        const std::size_t hi = batch * (w + 1) / workers;
+        for (std::size_t c = lo; c < hi; ++c) breed(c, w);
+        evaluateBatch<Objective>(childDurs + lo * n, hi - lo, n, childFit + lo);
+    };
+
+    const auto start = clock::now();
+    const auto deadline = start + std::chrono::milliseconds(params.timeBudgetMs);
+    long long best = *std::min_element(fit, fit + pop);
+    res.history.push_back({0, 0, best});
+
+    while (true) {
+        WorkerPool::local().run(workers, breedSlice);
+
+        // Steady-state replacement: each child displaces the current worst if better
+        for (std::size_t c = 0; c < batch; ++c) {
+            std::size_t worst = (std::size_t)(std::max_element(fit, fit + pop) - fit);
+            if (childFit[c] >= fit[worst]) continue;
+            std::copy_n(childGenes + c * n, n, genes + worst * n);
+            std::copy_n(childDurs + c * n, n, durs + worst * n);
+            fit[worst] = childFit[c];
+        }
+        ++res.generations;
+
+        if (params.polishEvery > 0 && elites > 0 && res.generations % params.polishEvery == 0) {
+            std::iota(rank, rank + pop, std::size_t{0});
+            std::partial_sort(rank, rank + elites, rank + pop,
+                              [&](std::size_t x, std::size_t y) { return fit[x] < fit[y]; });
+            for (std::size_t e = 0; e < elites; ++e) {
+                std::size_t r = rank[e];
+                fit[r] += improve2Swap<Objective>(genes + r * n, durs + r * n, n, deadline);
+            }
+        }
+
+        auto now = clock::now();
+        long long genBest = *std::min_element(fit, fit + pop);
+        if (genBest < best) {
+            best = genBest;
+            GaProgress p{std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count(),
+                         res.generations, best};
+            if (res.history.size() < kGaHistoryCapacity) res.history.push_back(p);
+            else res.history.back() = p;
+        }
+        if (now > deadline || (params.maxGenerations > 0 && res.generations >= params.maxGenerations))
+            break;
+    }
+
+    double secs = std::chrono::duration<double>(clock::now() - start).count();
+    std::size_t bestRow = (std::size_t)(std::min_element(fit, fit + pop) - fit);
+    res.order.assign(genes + bestRow * n, genes + (bestRow + 1) * n);
+    res.sumC = fit[bestRow];
+    res.generationsPerSec = secs > 0 ? (double)res.generations / secs : 0.0;
+}
+
+} // namespace kernels
+
+#endif // ZSSK_KERNELS_H
@@ -0,0 +1,26 @@
+#ifndef ZSSK_LEGACY_REFERENCE_H
+#define ZSSK_LEGACY_REFERENCE_H
+
+#pragma once
+#include <vector>
+#include "scheduler.h"
+#include "algorithms.h"
+
+// ======================================================
+// The algorithms as they were before the kernel templates, sequential paths
+// only; the kernel benchmark (option 9) runs them as its baseline row
+// ======================================================
+namespace legacy {
+
+long long calculateTotalCompletionTime(const std::vector<Task>& tasks,
+                                       const std::vector<int>& order);
+
+std::vector<int> sptOrder(const std::vector<Task>& tasks);
+
+std::vector<int> cheapestInsertionOrder(const std::vector<Task>& tasks);
+
+LsResult localSearch2Swap(const std::vector<Task>& tasks, const LsParams& params);
+
+} // namespace legacy
+
+#endif // ZSSK_LEGACY_REFERENCE_H
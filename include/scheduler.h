@@ -12,4 +12,7 @@ struct Task {
 
 std::vector<Task> loadTasks(const std::string& filename);
 
+// Loads into tasks, reusing its capacity; returns false (tasks empty) on error
+bool loadTasks(const std::string& filename, std::vector<Task>& tasks);
+
 #endif // ZSSK_SCHEDULER_H
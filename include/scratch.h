@@ -0,0 +1,66 @@
+#ifndef ZSSK_SCRATCH_H
+#define ZSSK_SCRATCH_H
+
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+// ======================================================
+// Per-thread bump allocator for algorithm scratch buffers.
+// Memory is handed out in LIFO scopes and kept between calls, so once the
+// arena has grown to the largest instance seen, solving allocates nothing.
+// ======================================================
+class ScratchArena {
+public:
+    struct Mark {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    // Arena of the calling thread
+    static ScratchArena& local();
+
+    // Uninitialized storage for count objects of T, valid until the enclosing scope ends
+    template <class T>
+    T* take(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "scratch memory is never destroyed");
+        return static_cast<T*>(takeBytes(count * sizeof(T), alignof(T)));
+    }
+
+    Mark mark() const { return {current, offset}; }
+    void release(const Mark& m);
+
+    std::size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    static constexpr std::size_t kMinBlockBytes = 64 * 1024;
+
+    void* takeBytes(std::size_t bytes, std::size_t align);
+    void addBlock(std::size_t bytes);
+
+    std::vector<Block> blocks;
+    std::size_t current = 0;   // block being filled
+    std::size_t offset = 0;    // first free byte in that block
+};
+
+// RAII scope: everything taken inside is returned when the scope ends
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena) : arena(arena), saved(arena.mark()) {}
+    ~ScratchScope() { arena.release(saved); }
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+private:
+    ScratchArena& arena;
+    ScratchArena::Mark saved;
+};
+
+#endif // ZSSK_SCRATCH_H
@@ -0,0 +1,44 @@
+#ifndef ZSSK_SERVER_H
+#define ZSSK_SERVER_H
+
+#pragma once
+#include <string>
+#include <cstddef>
+
+// ======================================================
+// Long-running solve server (JSON lines)
+//
+// Request, one per line:
+//   {"id": 7, "algo": "spt" | "ci" | "ls",
+//    "durations": [p1, p2, ...]  or  "file": "data/input_200.txt",
+//    "threads": 1, "order": true,
+//    "ls": {"maxNoImproveTries": 1000, "timeBudgetMs": 2000, "seed": 42}}
+// Response, one per line, in completion order:
+//   {"id": 7, "algo": "spt", "n": 200, "sumC": 123, "time_us": 15, "batch": 4, "order": [...]}
+//   {"id": 7, "error": "..."}
+// ======================================================
+struct ServerOptions {
+    int workers = 4;                       // shared solver pool size, also the per-request threads limit
+    std::string socketPath;                // empty -> serve stdin/stdout
+    std::size_t smallRequestTasks = 512;   // requests up to this size are batched
+    std::size_t batchTaskBudget = 8192;    // max total tasks in one batch
+    std::size_t maxBatchRequests = 64;
+    std::size_t maxQueuedRequests = 4096;  // readers block in submit beyond this
+};
+
+// Runs until stdin reaches EOF (or SIGINT/SIGTERM in socket mode); returns exit code
+int runSolveServer(const ServerOptions& options);
+
+struct LoadGenOptions {
+    int requests = 1000;
+    int size = 50;                         // tasks per request
+    std::string algo = "spt";
+    unsigned int seed = 42;
+    std::string socketPath;                // empty -> print requests to stdout
+};
+
+// Emits synthetic solve requests; against a socket it also reads the
+// responses back and reports the round-trip throughput
+int runLoadGenerator(const LoadGenOptions& options);
+
+#endif // ZSSK_SERVER_H
@@ -0,0 +1,54 @@
+#ifndef ZSSK_WORKER_POOL_H
+#define ZSSK_WORKER_POOL_H
+
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <type_traits>
+
+// ======================================================
+// Persistent helper threads for the parallel kernels.
+// Each calling thread owns its pool (so batch workers never wait on each
+// other); helpers are created on first use and reused for every later
+// round, and dispatching a round does not allocate.
+// ======================================================
+class WorkerPool {
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Pool of the calling thread
+    static WorkerPool& local();
+
+    // Runs fn(w) for w in [0, workers); the caller runs w = 0. Returns when all are done.
+    template <class Fn>
+    void run(int workers, Fn&& fn) {
+        using F = std::remove_reference_t<Fn>;
+        if (workers <= 1) { fn(0); return; }
+        dispatch(workers, (void*)&fn, [](void* ctx, int w) { (*static_cast<F*>(ctx))(w); });
+    }
+
+private:
+    using Call = void (*)(void*, int);
+
+    void dispatch(int workers, void* ctx, Call call);
+    void helperLoop(int w);
+
+    std::vector<std::thread> helpers;   // helpers[k] runs w = k + 1
+    std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::uint64_t epoch = 0;
+    int active = 0;                     // workers in the current round
+    int pending = 0;                    // helpers still running it
+    void* ctx = nullptr;
+    Call call = nullptr;
+    bool stopping = false;
+};
+
+#endif // ZSSK_WORKER_POOL_H
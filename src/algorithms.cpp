@@ -1,12 +1,25 @@
 #include "algorithms.h"
-#include <algorithm>
-#include <random>
-#include <thread>
-#include <mutex>
-#include <atomic>
-#include <iostream>
-#include <chrono>
-#include <execution>
+#include "kernels.h"
+#include "scratch.h"
+#include <limits>
+
+using Objective = kernels::TotalCompletionTime;
+
+// ======================================================
+// Kernel dispatch: threads > 1 selects the parallel policy, instances that
+// fit in 32-bit indices use the narrow order buffer.
+// ======================================================
+template <class Fn>
+static auto dispatchKernel(std::size_t n, int threads, Fn&& fn)
+{
+    const bool narrow = n <= std::numeric_limits<std::uint32_t>::max();
+    if (threads > 1) {
+        if (narrow) return fn(kernels::Parallel{}, std::uint32_t{});
+        return fn(kernels::Parallel{}, std::size_t{});
+    }
+    if (narrow) return fn(kernels::Sequential{}, std::uint32_t{});
+    return fn(kernels::Sequential{}, std::size_t{});
+}
 
 // ======================================================
 // Helper: compute total completion time ΣCi
@@ -14,179 +27,92 @@
 long long calculateTotalCompletionTime(const std::vector<Task>& tasks,
                                        const std::vector<int>& order)
 {
-    long long sum = 0;
-    long long current = 0;
-    for (int idx : order) {
-        current += tasks[idx].p;
-        sum += current;
-    }
-    return sum;
+    return Objective::evaluate(tasks, order.data(), order.size());
 }
 
 // ======================================================
 // Algorithm 1: SPT (Shortest Processing Time first)
 // ======================================================
-std::vector<int> sptOrder(const std::vector<Task>& tasks, int threads)
+void sptOrder(const std::vector<Task>& tasks, int threads, std::vector<int>& order)
 {
-    std::vector<int> order(tasks.size());
-    std::iota(order.begin(), order.end(), 0);
+    dispatchKernel(tasks.size(), threads, [&](auto policy, auto index) {
+        using Policy = decltype(policy);
+        using Index = decltype(index);
+        ScratchArena& arena = ScratchArena::local();
+        ScratchScope scope(arena);
+        Index* buf = arena.take<Index>(tasks.size());
+        kernels::priorityOrder<Objective, Policy, Index>(tasks, threads, buf);
+        order.assign(buf, buf + tasks.size());
+    });
+}
 
-    if (threads > 1) {
-        std::sort(std::execution::par, order.begin(), order.end(),
-                  [&](int a, int b){ return tasks[a].p < tasks[b].p; });
-    } else {
-        std::sort(order.begin(), order.end(),
-                  [&](int a, int b){ return tasks[a].p < tasks[b].p; });
-    }
+std::vector<int> sptOrder(const std::vector<Task>& tasks, int threads)
+{
+    std::vector<int> order;
+    sptOrder(tasks, threads, order);
     return order;
 }
 
 // ======================================================
 // Algorithm 2: Cheapest Insertion (parallel-aware)
 // ======================================================
-std::vector<int> cheapestInsertionOrder(const std::vector<Task>& tasks, int threads)
+void cheapestInsertionOrder(const std::vector<Task>& tasks, int threads, std::vector<int>& order)
 {
-    int n = (int)tasks.size();
-    if (n == 0) return {};
+    dispatchKernel(tasks.size(), threads, [&](auto policy, auto index) {
+        using Policy = decltype(policy);
+        using Index = decltype(index);
+        ScratchArena& arena = ScratchArena::local();
+        ScratchScope scope(arena);
+        Index* buf = arena.take<Index>(tasks.size());
+        kernels::cheapestInsertion<Objective, Policy, Index>(tasks, threads, buf);
+        order.assign(buf, buf + tasks.size());
+    });
+}
 
+std::vector<int> cheapestInsertionOrder(const std::vector<Task>& tasks, int threads)
+{
     std::vector<int> order;
-    order.reserve(n);
-
-    // Start with first two shortest tasks
-    std::vector<int> indices(n);
-    std::iota(indices.begin(), indices.end(), 0);
-    std::sort(indices.begin(), indices.end(), [&](int a, int b){ return tasks[a].p < tasks[b].p; });
-
-    order.push_back(indices[0]);
-    if (n > 1) order.push_back(indices[1]);
-
-    for (int i = 2; i < n; ++i) {
-        int t = indices[i];
-        long long bestIncrease = LLONG_MAX;
-        int bestPos = 0;
-
-        // Parallel section
-        if (threads > 1 && order.size() > 100) {
-            std::mutex mtx;
-            std::vector<std::thread> pool;
-            int chunk = std::max(1, (int)order.size() / threads);
-
-            for (int th = 0; th < threads; ++th) {
-                int start = th * chunk;
-                int end = std::min((int)order.size(), start + chunk);
-                pool.emplace_back([&, start, end] {
-                    long long localBest = LLONG_MAX;
-                    int localPos = start;
-                    for (int pos = start; pos <= end; ++pos) {
-                        std::vector<int> tmp = order;
-                        tmp.insert(tmp.begin() + pos, t);
-                        long long sum = calculateTotalCompletionTime(tasks, tmp);
-                        if (sum < localBest) {
-                            localBest = sum;
-                            localPos = pos;
-                        }
-                    }
-                    std::scoped_lock lock(mtx);
-                    if (localBest < bestIncrease) {
-                        bestIncrease = localBest;
-                        bestPos = localPos;
-                    }
-                });
-            }
-            for (auto& th : pool) th.join();
-        } else {
-            // Sequential fallback
-            for (int pos = 0; pos <= (int)order.size(); ++pos) {
-                std::vector<int> tmp = order;
-                tmp.insert(tmp.begin() + pos, t);
-                long long sum = calculateTotalCompletionTime(tasks, tmp);
-                if (sum < bestIncrease) {
-                    bestIncrease = sum;
-                    bestPos = pos;
-                }
-            }
-        }
-        order.insert(order.begin() + bestPos, t);
-    }
-
+    cheapestInsertionOrder(tasks, threads, order);
     return order;
 }
 
 // ======================================================
-// Algorithm 3: Local Search 2-swap (hybrid sequential/parallel)
+// Algorithm 3: Local Search 2-swap (sequential kernel, see kernels.h)
 // ======================================================
+void localSearch2Swap(const std::vector<Task>& tasks,
+                      const LsParams& params, int /*threads*/, LsResult& result)
+{
+    dispatchKernel(tasks.size(), 1, [&](auto, auto index) {
+        using Index = decltype(index);
+        kernels::localSearch2Swap<Objective, Index>(tasks, params, result);
+    });
+}
+
 LsResult localSearch2Swap(const std::vector<Task>& tasks,
                           const LsParams& params, int threads)
 {
-    int n = (int)tasks.size();
     LsResult res;
-    if (n == 0) return res;
-
-    std::vector<int> order(n);
-    std::iota(order.begin(), order.end(), 0);
-
-    std::mt19937 gen(params.seed);
-    std::shuffle(order.begin(), order.end(), gen);
-
-    long long bestSum = calculateTotalCompletionTime(tasks, order);
-    std::mutex bestMutex;
-    std::atomic<bool> improved{true};
-
-    auto start = std::chrono::steady_clock::now();
-
-    while (improved) {
-        improved = false;
-
-        if (threads > 1) {
-            std::atomic<int> iIndex = 0;
-            std::vector<std::thread> pool;
-            for (int t = 0; t < threads; ++t) {
-                pool.emplace_back([&]() {
-                    int i;
-                    while ((i = iIndex++) < n - 1) {
-                        for (int j = i + 1; j < n; ++j) {
-                            std::swap(order[i], order[j]);
-                            long long newSum = calculateTotalCompletionTime(tasks, order);
-                            std::swap(order[i], order[j]);
-                            if (newSum < bestSum) {
-                                std::scoped_lock lock(bestMutex);
-                                if (newSum < bestSum) {
-                                    bestSum = newSum;
-                                    improved = true;
-                                }
-                            }
-                            auto now = std::chrono::steady_clock::now();
-                            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count()
-                                > params.timeBudgetMs)
-                                return;
-                        }
-                    }
-                });
-            }
-            for (auto& th : pool) th.join();
-        } else {
-            for (int i = 0; i < n - 1; ++i) {
-                for (int j = i + 1; j < n; ++j) {
-                    std::swap(order[i], order[j]);
-                    long long newSum = calculateTotalCompletionTime(tasks, order);
-                    if (newSum < bestSum) {
-                        bestSum = newSum;
-                        improved = true;
-                    } else {
-                        std::swap(order[i], order[j]);
-                    }
+    localSearch2Swap(tasks, params, threads, res);
+    return res;
+}
 
-                    auto now = std::chrono::steady_clock::now();
-                    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count()
-                        > params.timeBudgetMs)
-                        break;
-                }
-                if (!improved) continue;
-            }
-        }
-    }
+// ======================================================
+// Algorithm 4: Steady-state genetic search (optional LS polish)
+// ======================================================
+void geneticOrder(const std::vector<Task>& tasks,
+                  const GaParams& params, int threads, GaResult& result)
+{
+    dispatchKernel(tasks.size(), threads, [&](auto policy, auto index) {
+        using Policy = decltype(policy);
+        using Index = decltype(index);
+        kernels::genetic<Objective, Policy, Index>(tasks, params, threads, result);
+    });
+}
 
-    res.order = order;
-    res.sumC = bestSum;
+GaResult geneticOrder(const std::vector<Task>& tasks,
+                      const GaParams& params, int threads)
+{
+    GaResult res;
+    geneticOrder(tasks, params, threads, res);
     return res;
 }
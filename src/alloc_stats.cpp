@@ -0,0 +1,130 @@
+#include "alloc_stats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+// ======================================================
+// Per-thread counters: operator new only touches its own thread's slot, so
+// counting adds no shared cache-line traffic. Slots are linked into a
+// registry on first use and fold their count into gRetired on thread exit;
+// allocationCount() sums them under the registry lock.
+// ======================================================
+namespace {
+
+struct CounterSlot;
+
+std::mutex gRegistryMutex;
+CounterSlot* gSlots = nullptr;
+std::uint64_t gRetired = 0;                    // guarded by gRegistryMutex
+std::atomic<std::uint64_t> gLateAllocations{0}; // after the thread's slot was destroyed
+
+struct CounterSlot {
+    std::atomic<std::uint64_t> count{0};       // written by the owner only
+    CounterSlot* prev = nullptr;
+    CounterSlot* next = nullptr;
+    bool linked = false;
+
+    CounterSlot() {
+        std::scoped_lock lock(gRegistryMutex);
+        next = gSlots;
+        if (next) next->prev = this;
+        gSlots = this;
+        linked = true;
+    }
+
+    ~CounterSlot() {
+        std::scoped_lock lock(gRegistryMutex);
+        gRetired += count.load(std::memory_order_relaxed);
+        if (prev) prev->next = next;
+        else gSlots = next;
+        if (next) next->prev = prev;
+        linked = false;
+    }
+
+    void add() {
+        if (linked) count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        else gLateAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+thread_local CounterSlot tSlot;
+
+} // namespace
+
+#if defined(ZSSK_ALLOC_STATS)
+
+static void* rawAlloc(std::size_t size, std::size_t align) {
+    if (size == 0) size = 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    if (align < sizeof(void*)) align = sizeof(void*);
+    void* p = nullptr;
+    if (posix_memalign(&p, align, size) != 0) return nullptr;
+    return p;
+}
+
+// Standard operator new semantics: retry through the installed new_handler,
+// throw bad_alloc only when there is none
+static void* countedAlloc(std::size_t size, std::size_t align) {
+    while (true) {
+        if (void* p = rawAlloc(size, align)) {
+            tSlot.add();
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+static void* countedAllocNoThrow(std::size_t size, std::size_t align) noexcept {
+    try {
+        return countedAlloc(size, align);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size) { return countedAlloc(size, 0); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size, 0); }
+
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlloc(size, (std::size_t)align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlloc(size, (std::size_t)align); }
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAllocNoThrow(size, (std::size_t)align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAllocNoThrow(size, (std::size_t)align);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+bool allocationStatsEnabled() { return true; }
+
+#else
+
+bool allocationStatsEnabled() { return false; }
+
+#endif
+
+std::uint64_t allocationCount() {
+    std::scoped_lock lock(gRegistryMutex);
+    std::uint64_t total = gRetired + gLateAllocations.load(std::memory_order_relaxed);
+    for (const CounterSlot* s = gSlots; s; s = s->next)
+        total += s->count.load(std::memory_order_relaxed);
+    return total;
+}
+
+std::uint64_t threadAllocationCount() { return tSlot.count.load(std::memory_order_relaxed); }
@@ -0,0 +1,269 @@
+#include "json.h"
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    if (type != Type::Object) return nullptr;
+    for (const auto& [k, v] : fields)
+        if (k == key) return &v;
+    return nullptr;
+}
+
+// ======================================================
+// Recursive-descent parser
+// ======================================================
+namespace {
+
+class Parser {
+public:
+    explicit Parser(const std::string& text) : s(text) {}
+
+    bool parseDocument(JsonValue& out, std::string& error) {
+        skipWs();
+        if (!parseValue(out, 0)) { error = err; return false; }
+        skipWs();
+        if (i != s.size()) { error = "trailing characters at offset " + std::to_string(i); return false; }
+        return true;
+    }
+
+private:
+    static constexpr int kMaxDepth = 64;
+
+    const std::string& s;
+    std::size_t i = 0;
+    std::string err;
+
+    bool fail(const std::string& what) {
+        err = what + " at offset " + std::to_string(i);
+        return false;
+    }
+
+    void skipWs() {
+        while (i < s.size() && std::isspace((unsigned char)s[i])) ++i;
+    }
+
+    bool literal(const char* word) {
+        std::size_t len = std::char_traits<char>::length(word);
+        if (s.compare(i, len, word) != 0) return fail("invalid literal");
+        i += len;
+        return true;
+    }
+
+    bool parseValue(JsonValue& v, int depth) {
+        if (depth > kMaxDepth) return fail("nesting too deep");
+        if (i >= s.size()) return fail("unexpected end of input");
+        switch (s[i]) {
+            case '{': return parseObject(v, depth);
+            case '[': return parseArray(v, depth);
+            case '"': v.type = JsonValue::Type::String; return parseString(v.str);
+            case 't': v.type = JsonValue::Type::Bool; v.boolean = true; return literal("true");
+            case 'f': v.type = JsonValue::Type::Bool; v.boolean = false; return literal("false");
+            case 'n': v.type = JsonValue::Type::Null; return literal("null");
+            default:  return parseNumber(v);
+        }
+    }
+
+    bool parseObject(JsonValue& v, int depth) {
+        v.type = JsonValue::Type::Object;
+        ++i; // '{'
+        skipWs();
+        if (i < s.size() && s[i] == '}') { ++i; return true; }
+        while (true) {
+            skipWs();
+            if (i >= s.size() || s[i] != '"') return fail("expected object key");
+            std::string key;
+            if (!parseString(key)) return false;
+            skipWs();
+            if (i >= s.size() || s[i] != ':') return fail("expected ':'");
+            ++i;
+            skipWs();
+            JsonValue member;
+            if (!parseValue(member, depth + 1)) return false;
+            v.fields.emplace_back(std::move(key), std::move(member));
+            skipWs();
+            if (i < s.size() && s[i] == ',') { ++i; continue; }
+            if (i < s.size() && s[i] == '}') { ++i; return true; }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    bool parseArray(JsonValue& v, int depth) {
+        v.type = JsonValue::Type::Array;
+        ++i; // '['
+        skipWs();
+        if (i < s.size() && s[i] == ']') { ++i; return true; }
+        while (true) {
+            skipWs();
+            JsonValue item;
+            if (!parseValue(item, depth + 1)) return false;
+            v.items.push_back(std::move(item));
+            skipWs();
+            if (i < s.size() && s[i] == ',') { ++i; continue; }
+            if (i < s.size() && s[i] == ']') { ++i; return true; }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    // JSON grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    // Scanned first so hex, inf/nan, leading '+' or zeros and bare '.' are
+    // rejected; from_chars then converts exactly that span, locale-free.
+    bool parseNumber(JsonValue& v) {
+        auto digit = [&](std::size_t k) { return k < s.size() && s[k] >= '0' && s[k] <= '9'; };
+        std::size_t k = i;
+        if (k < s.size() && s[k] == '-') ++k;
+        if (!digit(k)) return fail("invalid number");
+        if (s[k] == '0') ++k;
+        else while (digit(k)) ++k;
+        if (k < s.size() && s[k] == '.') {
+            if (!digit(++k)) return fail("invalid number");
+            while (digit(k)) ++k;
+        }
+        if (k < s.size() && (s[k] == 'e' || s[k] == 'E')) {
+            ++k;
+            if (k < s.size() && (s[k] == '+' || s[k] == '-')) ++k;
+            if (!digit(k)) return fail("invalid number");
+            while (digit(k)) ++k;
+        }
+        double d = 0.0;
+        auto [end, ec] = std::from_chars(s.data() + i, s.data() + k, d);
+        if (ec != std::errc() || end != s.data() + k || !std::isfinite(d)) return fail("invalid number");
+        v.type = JsonValue::Type::Number;
+        v.number = d;
+        i = k;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out.push_back((char)cp);
+        } else if (cp < 0x800) {
+            out.push_back((char)(0xC0 | (cp >> 6)));
+            out.push_back((char)(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back((char)(0xE0 | (cp >> 12)));
+            out.push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        ++i; // opening quote
+        while (i < s.size()) {
+            char c = s[i++];
+            if (c == '"') return true;
+            if (c != '\\') { out.push_back(c); continue; }
+            if (i >= s.size()) break;
+            char e = s[i++];
+            switch (e) {
+                case '"':  out.push_back('"');  break;
+                case '\\': out.push_back('\\'); break;
+                case '/':  out.push_back('/');  break;
+                case 'b':  out.push_back('\b'); break;
+                case 'f':  out.push_back('\f'); break;
+                case 'n':  out.push_back('\n'); break;
+                case 'r':  out.push_back('\r'); break;
+                case 't':  out.push_back('\t'); break;
+                case 'u': {
+                    if (i + 4 > s.size()) return fail("truncated \\u escape");
+                    unsigned cp = 0;
+                    for (int k = 0; k < 4; ++k) {
+                        char h = s[i++];
+                        cp <<= 4;
+                        if (h >= '0' && h <= '9') cp |= (unsigned)(h - '0');
+                        else if (h >= 'a' && h <= 'f') cp |= (unsigned)(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') cp |= (unsigned)(h - 'A' + 10);
+                        else return fail("invalid \\u escape");
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+};
+
+} // namespace
+
+bool parseJson(const std::string& text, JsonValue& out, std::string& error) {
+    out = JsonValue{};
+    Parser parser(text);
+    return parser.parseDocument(out, error);
+}
+
+// ======================================================
+// Serialization
+// ======================================================
+std::string jsonQuote(const std::string& s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    out.push_back('"');
+    for (char c : s) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+                    out += buf;
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+    return out;
+}
+
+static void writeJson(const JsonValue& v, std::string& out) {
+    switch (v.type) {
+        case JsonValue::Type::Null:   out += "null"; break;
+        case JsonValue::Type::Bool:   out += v.boolean ? "true" : "false"; break;
+        case JsonValue::Type::String: out += jsonQuote(v.str); break;
+        case JsonValue::Type::Number: {
+            if (v.number == std::floor(v.number) && std::fabs(v.number) < 9.0e15) {
+                out += std::to_string((long long)v.number);
+            } else {
+                char buf[32];
+                std::snprintf(buf, sizeof(buf), "%.17g", v.number);
+                out += buf;
+            }
+            break;
+        }
+        case JsonValue::Type::Array: {
+            out.push_back('[');
+            for (std::size_t k = 0; k < v.items.size(); ++k) {
+                if (k) out.push_back(',');
+                writeJson(v.items[k], out);
+            }
+            out.push_back(']');
+            break;
+        }
+        case JsonValue::Type::Object: {
+            out.push_back('{');
+            for (std::size_t k = 0; k < v.fields.size(); ++k) {
+                if (k) out.push_back(',');
+                out += jsonQuote(v.fields[k].first);
+                out.push_back(':');
+                writeJson(v.fields[k].second, out);
+            }
+            out.push_back('}');
+            break;
+        }
+    }
+}
+
+std::string toJson(const JsonValue& value) {
+    std::string out;
+    writeJson(value, out);
+    return out;
+}
@@ -11,10 +11,16 @@
 #include <map>
 #include <thread>
 #include <mutex>
+#include <algorithm>
+#include <atomic>
 
 #include "utils.h"
 #include "scheduler.h"
 #include "algorithms.h"
+#include "kernels.h"
+#include "server.h"
+#include "alloc_stats.h"
+#include "legacy_reference.h"
 
 static void clearInput() {
     std::cin.clear();
@@ -148,7 +154,7 @@ static void appendCsvRow(const std::string& csvPath,
 
 static void printSettingsHelp() {
     std::cout << "\n-- Settings help --\n";
-    std::cout << "threads: number of threads used in any algorithm (1/2/4/8).\n";
+    std::cout << "threads: number of threads used in any algorithm (1/2/4/8); LS 2-swap always runs sequentially.\n";
     std::cout << "time budget [ms]: time limit per local-search iteration (prevents infinite runs).\n";
     std::cout << "no-improve tries factor: limits local search effort, usually 1000*n.\n";
     std::cout << "seed: RNG seed; same seed -> reproducible results.\n";
@@ -161,9 +167,122 @@ static void printSettingsHelp() {
     std::cout << "\nFile format:\n";
     std::cout << "   Line 1: n\n   Line 2: p1 p2 ... pn\n";
 
+    std::cout << "\nServer mode (many small instances without process startup):\n";
+    std::cout << "   ZSSK --serve [--socket PATH]  reads JSON-lines solve requests\n";
+    std::cout << "   ZSSK --loadgen 10000 | ZSSK --serve > /dev/null  measures req/s\n";
+
     std::cout << "\nAll relative paths resolve from build dir (e.g. cmake-build-debug/)\n";
 }
 
+// Best ΣCi over time, thinned to at most 20 lines
+static void printGaHistory(const GaResult& res) {
+    const std::size_t maxLines = 20;
+    std::size_t step = std::max<std::size_t>(1, (res.history.size() + maxLines - 1) / maxLines);
+    std::cout << "  time_ms  generation  best_sumC\n";
+    for (std::size_t i = 0; i < res.history.size(); ++i) {
+        if (i % step != 0 && i + 1 != res.history.size()) continue;
+        const auto& h = res.history[i];
+        std::cout << "  " << std::setw(7) << h.timeMs
+                  << "  " << std::setw(10) << h.generation
+                  << "  " << h.bestSumC << "\n";
+    }
+}
+
+static std::string allocsText(std::uint64_t count) {
+    return allocationStatsEnabled() ? std::to_string(count) : std::string("n/a");
+}
+
+// Each kernel runs once to warm the scratch arena and worker pool, then the
+// timed run reports its heap allocations (0 once the hot paths are warm)
+template <class Policy, class Index>
+static void benchKernelVariant(const std::vector<Task>& tasks, int threads,
+                               const LsParams& lp, const std::string& label)
+{
+    using Objective = kernels::TotalCompletionTime;
+    const std::size_t n = tasks.size();
+    std::vector<Index> order(n);
+    LsResult ls;
+
+    auto measure = [&](auto&& kernel, long long& us, std::uint64_t& allocs) {
+        kernel();
+        AllocationProbe probe;
+        auto t0 = std::chrono::steady_clock::now();
+        kernel();
+        us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+        allocs = probe.allocations();
+    };
+
+    long long sptUs, ciUs, lsUs = 0;
+    std::uint64_t sptAllocs, ciAllocs, lsAllocs = 0;
+
+    measure([&] { kernels::priorityOrder<Objective, Policy, Index>(tasks, threads, order.data()); },
+            sptUs, sptAllocs);
+    long long sptSum = Objective::evaluate(tasks, order.data(), n);
+
+    measure([&] { kernels::cheapestInsertion<Objective, Policy, Index>(tasks, threads, order.data()); },
+            ciUs, ciAllocs);
+    long long ciSum = Objective::evaluate(tasks, order.data(), n);
+
+    std::cout << "[KERNEL] " << std::left << std::setw(10) << label << std::right
+              << " SPT: sumC=" << sptSum << " time=" << sptUs << " us allocs=" << allocsText(sptAllocs)
+              << " | CI: sumC=" << ciSum << " time=" << ciUs << " us allocs=" << allocsText(ciAllocs);
+
+    // LS has no parallel kernel; the seq rows cover it
+    if constexpr (Policy::parallel) {
+        std::cout << " | LS: sequential only\n";
+    } else {
+        measure([&] { kernels::localSearch2Swap<Objective, Index>(tasks, lp, ls); }, lsUs, lsAllocs);
+        std::cout << " | LS: sumC=" << ls.sumC << " time=" << lsUs << " us allocs=" << allocsText(lsAllocs) << "\n";
+    }
+}
+
+// Pre-template implementation (sequential paths), run once: it keeps no
+// state to warm up
+static void benchLegacy(const std::vector<Task>& tasks, const LsParams& lp)
+{
+    auto micros = [](auto t0) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+    };
+
+    AllocationProbe sptProbe;
+    auto t0 = std::chrono::steady_clock::now();
+    auto spt = legacy::sptOrder(tasks);
+    long long sptUs = micros(t0);
+    std::uint64_t sptAllocs = sptProbe.allocations();
+    long long sptSum = legacy::calculateTotalCompletionTime(tasks, spt);
+
+    AllocationProbe ciProbe;
+    t0 = std::chrono::steady_clock::now();
+    auto ci = legacy::cheapestInsertionOrder(tasks);
+    long long ciUs = micros(t0);
+    std::uint64_t ciAllocs = ciProbe.allocations();
+    long long ciSum = legacy::calculateTotalCompletionTime(tasks, ci);
+
+    AllocationProbe lsProbe;
+    t0 = std::chrono::steady_clock::now();
+    auto ls = legacy::localSearch2Swap(tasks, lp);
+    long long lsUs = micros(t0);
+    std::uint64_t lsAllocs = lsProbe.allocations();
+
+    std::cout << "[KERNEL] " << std::left << std::setw(10) << "legacy/seq" << std::right
+              << " SPT: sumC=" << sptSum << " time=" << sptUs << " us allocs=" << allocsText(sptAllocs)
+              << " | CI: sumC=" << ciSum << " time=" << ciUs << " us allocs=" << allocsText(ciAllocs)
+              << " | LS: sumC=" << ls.sumC << " time=" << lsUs << " us allocs=" << allocsText(lsAllocs) << "\n";
+}
+
+static void runKernelBenchmark(const std::vector<Task>& tasks, int threads, const LsParams& lp)
+{
+    benchLegacy(tasks, lp);
+    benchKernelVariant<kernels::Sequential, std::uint32_t>(tasks, threads, lp, "seq/u32");
+    benchKernelVariant<kernels::Sequential, std::size_t>(tasks, threads, lp, "seq/size_t");
+    if (threads > 1) {
+        benchKernelVariant<kernels::Parallel, std::uint32_t>(tasks, threads, lp, "par/u32");
+        benchKernelVariant<kernels::Parallel, std::size_t>(tasks, threads, lp, "par/size_t");
+    }
+}
+
 void runBatchExperiments(const std::string& folder,
                          const std::string& csvPath,
                          int threads,
@@ -185,29 +304,38 @@ void runBatchExperiments(const std::string& folder,
     std::atomic<size_t> nextIdx = 0;
 
     auto worker = [&](int id) {
+        // Reused for every instance this worker solves
+        std::vector<Task> tasks;
+        std::vector<int> ord1, ord2;
+        LsResult res;
+
         while (true) {
             size_t idx = nextIdx++;
             if (idx >= files.size()) break;
             const auto& file = files[idx];
-            auto tasks = loadTasks(file.string());
-            if (tasks.empty()) continue;
+            // The iteration count includes file loading and CSV output, whose
+            // streams allocate per instance; the solve count covers the kernels only
+            AllocationProbe iterProbe;
+            if (!loadTasks(file.string(), tasks)) continue;
 
+            AllocationProbe probe;
             auto t0 = std::chrono::steady_clock::now();
-            auto ord1 = sptOrder(tasks, threads);
+            sptOrder(tasks, threads, ord1);
             long long s1 = calculateTotalCompletionTime(tasks, ord1);
             long long t1 = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now() - t0).count();
 
             auto t2 = std::chrono::steady_clock::now();
-            auto ord2 = cheapestInsertionOrder(tasks, threads);
+            cheapestInsertionOrder(tasks, threads, ord2);
             long long s2 = calculateTotalCompletionTime(tasks, ord2);
             long long t3 = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now() - t2).count();
 
             auto t4 = std::chrono::steady_clock::now();
-            auto res = localSearch2Swap(tasks, lsParams, threads);
+            localSearch2Swap(tasks, lsParams, threads, res);
             long long t5 = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::steady_clock::now() - t4).count();
+            std::uint64_t solveAllocs = probe.threadAllocations();
 
             {
                 std::scoped_lock lock(csvMutex);
@@ -216,7 +344,11 @@ void runBatchExperiments(const std::string& folder,
                 appendCsvRow(csvPath, file.filename().string(), "LocalSearch", (int)tasks.size(), threads, t5, res.sumC);
             }
 
-            std::cout << "[Thread " << id << "] Done: " << file.filename() << "\n";
+            std::uint64_t iterAllocs = iterProbe.threadAllocations();
+
+            std::cout << "[Thread " << id << "] Done: " << file.filename()
+                      << " (allocs=" << allocsText(iterAllocs)
+                      << " incl. load/CSV, solve-only=" << allocsText(solveAllocs) << ")\n";
         }
     };
 
@@ -228,9 +360,59 @@ void runBatchExperiments(const std::string& folder,
     std::cout << "Batch experiments completed for " << files.size() << " instances.\n";
 }
 
-int main() {
+static void printUsage() {
+    std::cout << "Usage:\n";
+    std::cout << "  ZSSK                              interactive menu\n";
+    std::cout << "  ZSSK --serve [--socket PATH] [--workers N] [--small-tasks N] [--batch-tasks N]\n";
+    std::cout << "              [--queue N]\n";
+    std::cout << "        JSON-lines solve server on stdin/stdout or a Unix domain socket\n";
+    std::cout << "  ZSSK --loadgen COUNT [--size N] [--algo spt|ci|ls] [--seed S] [--socket PATH]\n";
+    std::cout << "        synthetic requests to stdout, or round-trip throughput against a socket\n";
+}
+
+// Non-interactive modes; returns -1 when the menu should run instead
+static int runCommandLine(int argc, char** argv) {
+    if (argc <= 1) return -1;
+
+    ServerOptions so;
+    so.workers = (int)std::max(1u, std::thread::hardware_concurrency());
+    LoadGenOptions lo;
+    bool serve = false, loadgen = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (arg == "--serve") serve = true;
+            else if (arg == "--loadgen" && hasValue) { loadgen = true; lo.requests = std::stoi(argv[++i]); }
+            else if (arg == "--socket" && hasValue) so.socketPath = lo.socketPath = argv[++i];
+            else if (arg == "--workers" && hasValue) so.workers = std::stoi(argv[++i]);
+            else if (arg == "--small-tasks" && hasValue) so.smallRequestTasks = std::stoul(argv[++i]);
+            else if (arg == "--batch-tasks" && hasValue) so.batchTaskBudget = std::stoul(argv[++i]);
+            else if (arg == "--queue" && hasValue) so.maxQueuedRequests = std::stoul(argv[++i]);
+            else if (arg == "--size" && hasValue) lo.size = std::stoi(argv[++i]);
+            else if (arg == "--algo" && hasValue) lo.algo = argv[++i];
+            else if (arg == "--seed" && hasValue) lo.seed = (unsigned int)std::stoul(argv[++i]);
+            else { printUsage(); return 2; }
+        } catch (const std::exception&) {
+            std::cerr << "Error: invalid value for " << arg << "\n";
+            return 2;
+        }
+    }
+
+    if (serve == loadgen) { printUsage(); return 2; }
+    return serve ? runSolveServer(so) : runLoadGenerator(lo);
+}
+
+int main(int argc, char** argv) {
+    if (int rc = runCommandLine(argc, argv); rc >= 0) return rc;
+
     std::vector<Task> tasks;
     std::string currentInstance = "NA";
+    // Result buffers reused by "Benchmark all", so repeated runs stay allocation-free
+    std::vector<int> benchOrder;
+    LsResult benchLs;
+    GaResult benchGa;
     bool running = true;
 
     while (running) {
@@ -242,9 +424,11 @@ int main() {
         std::cout << "3) Run SPT\n";
         std::cout << "4) Run Cheapest Insertion\n";
         std::cout << "5) Run Local Search 2-swap\n";
-        std::cout << "6) Benchmark all (SPT, CI, LS)\n";
+        std::cout << "6) Benchmark all (SPT, CI, LS, GA)\n";
         std::cout << "7) Help (settings)\n";
         std::cout << "8) Run batch experiments (parallel over multiple input files)\n"; // 💥 TĘ LINIE DODAJ
+        std::cout << "9) Kernel benchmark (legacy vs execution policy x index width)\n";
+        std::cout << "10) Run Genetic algorithm (population, batched fitness)\n";
         std::cout << "0) Exit\n";
         std::cout << "Choose option: ";
 
@@ -357,34 +541,57 @@ int main() {
 
                 // SPT
                 {
+                    AllocationProbe probe;
                     auto t0 = std::chrono::steady_clock::now();
-                    auto ord = sptOrder(tasks, threads);
-                    long long sumC = calculateTotalCompletionTime(tasks, ord);
+                    sptOrder(tasks, threads, benchOrder);
+                    long long sumC = calculateTotalCompletionTime(tasks, benchOrder);
                     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                             std::chrono::steady_clock::now() - t0).count();
-                    std::cout << "[BENCH] SPT: sumC=" << sumC << " time=" << ms << " ms\n";
+                    std::cout << "[BENCH] SPT: sumC=" << sumC << " time=" << ms << " ms"
+                              << " allocs=" << allocsText(probe.allocations()) << "\n";
                     appendCsvRow(csv, currentInstance, "SPT", (int)tasks.size(), threads, ms, sumC);
                 }
                 // CI
                 {
+                    AllocationProbe probe;
                     auto t0 = std::chrono::steady_clock::now();
-                    auto ord = cheapestInsertionOrder(tasks, threads);
-                    long long sumC = calculateTotalCompletionTime(tasks, ord);
+                    cheapestInsertionOrder(tasks, threads, benchOrder);
+                    long long sumC = calculateTotalCompletionTime(tasks, benchOrder);
                     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                             std::chrono::steady_clock::now() - t0).count();
-                    std::cout << "[BENCH] CI: sumC=" << sumC << " time=" << ms << " ms\n";
+                    std::cout << "[BENCH] CI: sumC=" << sumC << " time=" << ms << " ms"
+                              << " allocs=" << allocsText(probe.allocations()) << "\n";
                     appendCsvRow(csv, currentInstance, "CheapestInsertion", (int)tasks.size(), threads, ms, sumC);
                 }
                 // LS
                 {
+                    AllocationProbe probe;
                     auto t0 = std::chrono::steady_clock::now();
-                    auto res = localSearch2Swap(tasks, lp, threads);
-                    long long sumC = res.sumC;
+                    localSearch2Swap(tasks, lp, threads, benchLs);
+                    long long sumC = benchLs.sumC;
                     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                             std::chrono::steady_clock::now() - t0).count();
-                    std::cout << "[BENCH] LS: sumC=" << sumC << " time=" << ms << " ms\n";
+                    std::cout << "[BENCH] LS: sumC=" << sumC << " time=" << ms << " ms"
+                              << " allocs=" << allocsText(probe.allocations()) << "\n";
                     appendCsvRow(csv, currentInstance, "LocalSearch", (int)tasks.size(), threads, ms, sumC);
                 }
+                // GA (same time budget and seed as LS)
+                {
+                    GaParams gp;
+                    gp.timeBudgetMs = timeBudgetMs;
+                    gp.seed = seed;
+
+                    AllocationProbe probe;
+                    auto t0 = std::chrono::steady_clock::now();
+                    geneticOrder(tasks, gp, threads, benchGa);
+                    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - t0).count();
+                    std::cout << "[BENCH] GA: sumC=" << benchGa.sumC << " time=" << ms << " ms"
+                              << " generations=" << benchGa.generations
+                              << " gen/s=" << (long long)benchGa.generationsPerSec
+                              << " allocs=" << allocsText(probe.allocations()) << "\n";
+                    appendCsvRow(csv, currentInstance, "Genetic", (int)tasks.size(), threads, ms, benchGa.sumC);
+                }
                 break;
             }
 
@@ -409,6 +616,47 @@ int main() {
                 break;
             }
 
+            case 10: { // Genetic algorithm
+                if (tasks.empty()) { std::cout << "No tasks loaded.\n"; break; }
+
+                int threads = askInt("Threads (1/2/4/8)", 1);
+                GaParams gp;
+                gp.timeBudgetMs = askInt("Time budget [ms]", 2000);
+                gp.seed = (unsigned int)askInt("Random seed", 42);
+                gp.populationSize = askInt("Population size", 64);
+                gp.offspringPerGeneration = askInt("Offspring per generation (fitness batch)", 32);
+                gp.polishEvery = askInt("LS polish of elites every N generations (0=off)", 0);
+
+                auto t0 = std::chrono::steady_clock::now();
+                auto res = geneticOrder(tasks, gp, threads);
+                auto t1 = std::chrono::steady_clock::now();
+                long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+
+                std::cout << "Genetic: sumC=" << res.sumC << " time=" << ms << " ms, threads=" << threads
+                          << ", generations=" << res.generations
+                          << ", gen/s=" << (long long)res.generationsPerSec << "\n";
+                printGaHistory(res);
+                if (askYesNo("Append to CSV?")) {
+                    std::string csv = askStr("CSV path", "results.csv");
+                    appendCsvRow(csv, currentInstance, "Genetic", (int)tasks.size(), threads, ms, res.sumC);
+                }
+                break;
+            }
+
+            case 9: {
+                if (tasks.empty()) { std::cout << "No tasks loaded.\n"; break; }
+                int threads = askInt("Threads (1/2/4/8)", 1);
+                int timeBudgetMs = askInt("LS: Time budget [ms]", 2000);
+                unsigned int seed = (unsigned int)askInt("Random seed", 42);
+
+                LsParams lp;
+                lp.timeBudgetMs = timeBudgetMs;
+                lp.seed = seed;
+
+                runKernelBenchmark(tasks, threads, lp);
+                break;
+            }
+
             default:
                 std::cout << "Invalid option.\n";
                 break;
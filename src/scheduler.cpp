@@ -3,20 +3,26 @@
 #include <iostream>
 
 std::vector<Task> loadTasks(const std::string& filename) {
+    std::vector<Task> tasks;
+    loadTasks(filename, tasks);
+    return tasks;
+}
+
+bool loadTasks(const std::string& filename, std::vector<Task>& tasks) {
+    tasks.clear();
     std::ifstream in(filename);
     if (!in.is_open()) {
         std::cerr << "Error: cannot open file " << filename << "\n";
-        return {};
+        return false;
     }
 
     int n;
     in >> n;
     if (!in || n <= 0) {
         std::cerr << "Error: invalid number of tasks in file " << filename << "\n";
-        return {};
+        return false;
     }
 
-    std::vector<Task> tasks;
     tasks.reserve(n);
 
     for (int i = 0; i < n; ++i) {
@@ -25,10 +31,10 @@ std::vector<Task> loadTasks(const std::string& filename) {
         if (!in) {
             std::cerr << "Error: invalid data format in file " << filename << "\n";
             tasks.clear();
-            return tasks;
+            return false;
         }
         tasks.push_back({i + 1, p});
     }
 
-    return tasks;
+    return true;
 }
@@ -0,0 +1,53 @@
+#include "scratch.h"
+#include <algorithm>
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+void ScratchArena::addBlock(std::size_t bytes) {
+    Block b;
+    b.data = std::make_unique_for_overwrite<std::byte[]>(bytes);
+    b.size = bytes;
+    blocks.push_back(std::move(b));
+}
+
+void* ScratchArena::takeBytes(std::size_t bytes, std::size_t align) {
+    // Continue in the current block, else the next one that fits, else grow
+    for (std::size_t b = current; b < blocks.size(); ++b) {
+        std::size_t start = (b == current) ? offset : 0;
+        start = (start + align - 1) / align * align;
+        if (start + bytes <= blocks[b].size) {
+            current = b;
+            offset = start + bytes;
+            return blocks[b].data.get() + start;
+        }
+    }
+
+    std::size_t last = blocks.empty() ? 0 : blocks.back().size;
+    addBlock(std::max({kMinBlockBytes, 2 * last, bytes + align}));
+    current = blocks.size() - 1;
+    std::size_t start = 0;
+    offset = start + bytes;
+    return blocks[current].data.get() + start;
+}
+
+void ScratchArena::release(const Mark& m) {
+    current = m.block;
+    offset = m.offset;
+
+    // Back at the bottom after a growth spurt: merge into one block so the
+    // next call of the same size fits without touching the heap
+    if (current == 0 && offset == 0 && blocks.size() > 1) {
+        std::size_t total = capacity();
+        blocks.clear();
+        addBlock(total);
+    }
+}
+
+std::size_t ScratchArena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& b : blocks) total += b.size;
+    return total;
+}
@@ -0,0 +1,578 @@
+#include "server.h"
+#include "json.h"
+#include "scheduler.h"
+#include "algorithms.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <set>
+#include <string_view>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace {
+
+// ======================================================
+// Response destination: stdout, or one socket connection
+// ======================================================
+class ResultSink {
+public:
+    ResultSink() = default;                    // stdout
+    explicit ResultSink(int fd) : fd(fd), opened(std::chrono::steady_clock::now()) {}    // owned socket
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    // A socket connection reports its own throughput, connect to last response
+    ~ResultSink() {
+#if !defined(_WIN32)
+        if (fd >= 0) {
+            close(fd);
+            double ms = std::chrono::duration<double, std::milli>(lastWrite - opened).count();
+            if (responses > 0 && ms > 0)
+                std::cerr << "[server] connection: " << responses << " requests in " << (long long)ms
+                          << " ms (" << (long long)(responses * 1000.0 / ms) << " req/s)\n";
+        }
+#endif
+    }
+
+    void write(const std::string& data, std::size_t count) {
+        std::scoped_lock lock(mtx);
+        responses += count;
+        lastWrite = std::chrono::steady_clock::now();
+        if (fd < 0) {
+            std::cout.write(data.data(), (std::streamsize)data.size());
+            std::cout.flush();
+            return;
+        }
+#if !defined(_WIN32)
+        std::size_t off = 0;
+        while (off < data.size()) {
+            ssize_t w = send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return;   // client went away; drop the rest
+            off += (std::size_t)w;
+        }
+#endif
+    }
+
+private:
+    int fd = -1;
+    std::mutex mtx;
+    std::size_t responses = 0;
+    std::chrono::steady_clock::time_point opened{};
+    std::chrono::steady_clock::time_point lastWrite{};
+};
+
+// ======================================================
+// One parsed solve request
+// ======================================================
+struct SolveJob {
+    std::string idJson = "null";   // echoed back verbatim
+    std::string algo;
+    std::vector<Task> tasks;       // inline durations, or loaded from file by the worker
+    std::string file;
+    LsParams ls;
+    int threads = 1;
+    bool withOrder = true;
+    std::string error;             // answered without solving
+    std::shared_ptr<ResultSink> sink;
+
+    // Batching weight; file-backed requests count as one small request
+    std::size_t weight(const ServerOptions& opt) const {
+        return tasks.empty() ? opt.smallRequestTasks : tasks.size();
+    }
+};
+
+bool readInt(const JsonValue* v, int& out) {
+    if (!v || !v->isNumber() || v->number != std::floor(v->number) ||
+        v->number < INT_MIN || v->number > INT_MAX)
+        return false;
+    out = (int)v->number;
+    return true;
+}
+
+bool readUnsigned(const JsonValue* v, unsigned int& out) {
+    if (!v || !v->isNumber() || v->number != std::floor(v->number) ||
+        v->number < 0 || v->number > UINT_MAX)
+        return false;
+    out = (unsigned int)v->number;
+    return true;
+}
+
+// maxThreads bounds the per-request kernel threads (helpers stay alive in the worker's pool)
+void parseRequest(const std::string& line, SolveJob& job, int maxThreads) {
+    JsonValue req;
+    std::string err;
+    if (!parseJson(line, req, err)) { job.error = "invalid JSON: " + err; return; }
+    if (!req.isObject()) { job.error = "request must be a JSON object"; return; }
+
+    if (const JsonValue* id = req.find("id")) job.idJson = toJson(*id);
+
+    const JsonValue* algo = req.find("algo");
+    job.algo = (algo && algo->isString()) ? algo->str : "spt";
+    if (job.algo != "spt" && job.algo != "ci" && job.algo != "ls") {
+        job.error = "unknown algo '" + job.algo + "' (expected spt, ci or ls)";
+        return;
+    }
+
+    if (const JsonValue* d = req.find("durations")) {
+        if (!d->isArray()) { job.error = "durations must be an array"; return; }
+        job.tasks.reserve(d->items.size());
+        for (std::size_t i = 0; i < d->items.size(); ++i) {
+            int p;
+            if (!readInt(&d->items[i], p) || p < 0) {
+                job.error = "invalid duration at index " + std::to_string(i);
+                return;
+            }
+            job.tasks.push_back({(int)i + 1, p});
+        }
+        if (job.tasks.empty()) { job.error = "durations is empty"; return; }
+    } else if (const JsonValue* f = req.find("file"); f && f->isString()) {
+        job.file = f->str;
+    } else {
+        job.error = "request needs 'durations' or 'file'";
+        return;
+    }
+
+    if (const JsonValue* t = req.find("threads"); t && (!readInt(t, job.threads) || job.threads < 1)) {
+        job.error = "threads must be a positive integer";
+        return;
+    }
+    if (job.threads > maxThreads) {
+        job.error = "threads must be at most " + std::to_string(maxThreads);
+        return;
+    }
+    if (const JsonValue* o = req.find("order"); o && o->type == JsonValue::Type::Bool)
+        job.withOrder = o->boolean;
+
+    if (const JsonValue* ls = req.find("ls"); ls && ls->isObject()) {
+        if ((ls->find("maxNoImproveTries") && !readInt(ls->find("maxNoImproveTries"), job.ls.maxNoImproveTries)) ||
+            (ls->find("timeBudgetMs") && !readInt(ls->find("timeBudgetMs"), job.ls.timeBudgetMs))) {
+            job.error = "ls parameters must be integers";
+            return;
+        }
+        if (ls->find("seed") && !readUnsigned(ls->find("seed"), job.ls.seed)) {
+            job.error = "ls.seed must be an integer in [0, " + std::to_string(UINT_MAX) + "]";
+            return;
+        }
+    }
+}
+
+// order and lsRes are the worker's reusable result buffers
+void solveJob(SolveJob& job, std::size_t batchSize, std::string& out,
+              std::vector<int>& order, LsResult& lsRes) {
+    if (job.error.empty() && job.tasks.empty()) {
+        if (!loadTasks(job.file, job.tasks)) job.error = "cannot load tasks from " + job.file;
+    }
+    if (!job.error.empty()) {
+        out += "{\"id\":" + job.idJson + ",\"error\":" + jsonQuote(job.error) + "}\n";
+        return;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long sumC;
+    const std::vector<int>* result = &order;
+    if (job.algo == "spt") {
+        sptOrder(job.tasks, job.threads, order);
+        sumC = calculateTotalCompletionTime(job.tasks, order);
+    } else if (job.algo == "ci") {
+        cheapestInsertionOrder(job.tasks, job.threads, order);
+        sumC = calculateTotalCompletionTime(job.tasks, order);
+    } else {
+        localSearch2Swap(job.tasks, job.ls, job.threads, lsRes);
+        result = &lsRes.order;
+        sumC = lsRes.sumC;
+    }
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+
+    out += "{\"id\":" + job.idJson +
+           ",\"algo\":\"" + job.algo + "\"" +
+           ",\"n\":" + std::to_string(job.tasks.size()) +
+           ",\"sumC\":" + std::to_string(sumC) +
+           ",\"time_us\":" + std::to_string(us) +
+           ",\"batch\":" + std::to_string(batchSize);
+    if (job.withOrder) {
+        out += ",\"order\":[";
+        for (std::size_t k = 0; k < result->size(); ++k) {
+            if (k) out.push_back(',');
+            out += std::to_string(job.tasks[(*result)[k]].id);
+        }
+        out.push_back(']');
+    }
+    out += "}\n";
+}
+
+// ======================================================
+// Shared worker pool with request batching
+// ======================================================
+class SolveServer {
+public:
+    explicit SolveServer(const ServerOptions& opt) : opt(opt) {}
+
+    const ServerOptions& options() const { return opt; }
+
+    void start() {
+        for (int w = 0; w < std::max(1, opt.workers); ++w)
+            pool.emplace_back([this] { workerLoop(); });
+    }
+
+    // Blocks the calling reader while the queue is full, so a fast producer
+    // is throttled to the solve rate instead of growing the queue
+    void submit(SolveJob job) {
+        {
+            std::unique_lock lock(mtx);
+            std::size_t limit = std::max<std::size_t>(1, opt.maxQueuedRequests);
+            space.wait(lock, [&] { return queue.size() < limit; });
+            auto now = std::chrono::steady_clock::now();
+            if (received == 0) firstRequest = now;
+            if (pending++ == 0) busyStart = now;
+            ++received;
+            queue.push_back(std::move(job));
+        }
+        cv.notify_one();
+    }
+
+    // Drains the queue and stops the workers
+    void finish() {
+        {
+            std::scoped_lock lock(mtx);
+            closing = true;
+        }
+        cv.notify_all();
+        for (auto& th : pool) th.join();
+        pool.clear();
+    }
+
+    // Throughput is taken over busy time (some request queued or in flight),
+    // so idle gaps between socket clients do not dilute it; the span from the
+    // first request to the last result is reported separately
+    void printStats() const {
+        double busyMs = std::chrono::duration<double, std::milli>(busyTime).count();
+        double spanMs = std::chrono::duration<double, std::milli>(lastResult - firstRequest).count();
+        std::size_t served = completed.load();
+        std::size_t b = batches.load();
+        std::cerr << "[server] " << served << " requests, busy " << (long long)busyMs << " ms";
+        if (busyMs > 0) std::cerr << " (" << (long long)(served * 1000.0 / busyMs) << " req/s)";
+        std::cerr << " in " << busyPeriods << " busy periods, span " << (long long)spanMs << " ms";
+        std::cerr << ", " << b << " batches";
+        if (b > 0) std::cerr << ", avg " << (double)served / (double)b << " req/batch";
+        std::cerr << ", workers=" << std::max(1, opt.workers) << "\n";
+    }
+
+private:
+    bool isSmall(const SolveJob& job) const { return job.weight(opt) <= opt.smallRequestTasks; }
+
+    // Takes the front request plus, if it is small, the small ones queued behind it
+    void takeBatch(std::vector<SolveJob>& batch) {
+        batch.push_back(std::move(queue.front()));
+        queue.pop_front();
+        if (!isSmall(batch.front())) return;
+
+        std::size_t budget = batch.front().weight(opt);
+        while (!queue.empty() && batch.size() < opt.maxBatchRequests && isSmall(queue.front())) {
+            std::size_t w = queue.front().weight(opt);
+            if (budget + w > opt.batchTaskBudget) break;
+            budget += w;
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+    }
+
+    void workerLoop() {
+        std::vector<SolveJob> batch;
+        std::string out;
+        std::vector<int> order;
+        LsResult lsRes;
+        while (true) {
+            batch.clear();
+            {
+                std::unique_lock lock(mtx);
+                cv.wait(lock, [this] { return !queue.empty() || closing; });
+                if (queue.empty()) return;
+                takeBatch(batch);
+            }
+            space.notify_all();
+
+            // Responses for the same connection are written with one call
+            std::size_t runStart = 0;
+            for (std::size_t k = 0; k < batch.size(); ++k) {
+                try {
+                    solveJob(batch[k], batch.size(), out, order, lsRes);
+                } catch (const std::exception& e) {
+                    out += "{\"id\":" + batch[k].idJson + ",\"error\":" +
+                           jsonQuote(std::string("solve failed: ") + e.what()) + "}\n";
+                }
+                bool last = k + 1 == batch.size() || batch[k + 1].sink != batch[k].sink;
+                if (last) {
+                    batch[k].sink->write(out, k + 1 - runStart);
+                    out.clear();
+                    runStart = k + 1;
+                }
+            }
+
+            batches++;
+            completed += batch.size();
+            std::scoped_lock lock(mtx);
+            lastResult = std::chrono::steady_clock::now();
+            pending -= batch.size();
+            if (pending == 0) {
+                busyTime += lastResult - busyStart;
+                ++busyPeriods;
+            }
+        }
+    }
+
+    const ServerOptions& opt;
+    std::vector<std::thread> pool;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable space;  // signalled when workers take from the queue
+    std::deque<SolveJob> queue;
+    bool closing = false;
+
+    std::size_t received = 0;
+    std::size_t pending = 0;        // received but not yet answered
+    std::size_t busyPeriods = 0;
+    std::atomic<std::size_t> completed = 0;
+    std::atomic<std::size_t> batches = 0;
+    std::chrono::steady_clock::time_point firstRequest{};
+    std::chrono::steady_clock::time_point lastResult{};
+    std::chrono::steady_clock::time_point busyStart{};
+    std::chrono::steady_clock::duration busyTime{};
+};
+
+void submitLine(SolveServer& server, const std::string& line, const std::shared_ptr<ResultSink>& sink) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) return;
+    SolveJob job;
+    parseRequest(line, job, std::max(1, server.options().workers));
+    job.sink = sink;
+    server.submit(std::move(job));
+}
+
+#if !defined(_WIN32)
+std::atomic<int> gListenFd{-1};
+
+void onStopSignal(int) {
+    int fd = gListenFd.exchange(-1);
+    if (fd >= 0) shutdown(fd, SHUT_RDWR);   // wakes up accept()
+}
+
+int serveSocket(SolveServer& server, const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: socket path too long: " << path << "\n";
+        return 1;
+    }
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: cannot create socket\n";
+        return 1;
+    }
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, path.size());
+    unlink(path.c_str());
+    if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, 64) < 0) {
+        std::cerr << "Error: cannot listen on " << path << "\n";
+        close(listenFd);
+        return 1;
+    }
+
+    gListenFd = listenFd;
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    std::cerr << "[server] listening on " << path << "\n";
+
+    // Readers are detached; the set of open connections doubles as the live
+    // reader count, so shutdown waits on it instead of joining every thread
+    // ever accepted. Shared ownership keeps it valid for the last reader.
+    struct Connections {
+        std::mutex mtx;
+        std::condition_variable drained;
+        std::set<int> open;
+    };
+    auto conns = std::make_shared<Connections>();
+
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR && gListenFd >= 0) continue;
+            break;
+        }
+        {
+            std::scoped_lock lock(conns->mtx);
+            conns->open.insert(fd);
+        }
+        std::thread([&server, conns, fd] {
+            auto sink = std::make_shared<ResultSink>(fd);
+            std::string buf;
+            char chunk[1 << 16];
+            ssize_t r;
+            while ((r = read(fd, chunk, sizeof(chunk))) != 0) {
+                if (r < 0) {
+                    if (errno == EINTR) continue;
+                    break;
+                }
+                buf.append(chunk, (std::size_t)r);
+                std::size_t start = 0, nl;
+                while ((nl = buf.find('\n', start)) != std::string::npos) {
+                    submitLine(server, buf.substr(start, nl - start), sink);
+                    start = nl + 1;
+                }
+                buf.erase(0, start);
+            }
+            if (!buf.empty()) submitLine(server, buf, sink);
+            {
+                // Erased while this reader still owns the sink, so fd is not
+                // closed yet and accept cannot hand the same number to a new
+                // connection whose entry this erase would remove
+                std::scoped_lock lock(conns->mtx);
+                conns->open.erase(fd);
+                if (conns->open.empty()) conns->drained.notify_all();
+            }
+            // the sink closes fd once the last pending response is written
+            sink.reset();
+        }).detach();
+    }
+
+    {
+        std::unique_lock lock(conns->mtx);
+        for (int fd : conns->open) shutdown(fd, SHUT_RD);
+        conns->drained.wait(lock, [&] { return conns->open.empty(); });
+    }
+    close(listenFd);
+    unlink(path.c_str());
+    return 0;
+}
+#endif
+
+} // namespace
+
+int runSolveServer(const ServerOptions& options) {
+    SolveServer server(options);
+    server.start();
+
+    int rc = 0;
+    if (options.socketPath.empty()) {
+        std::ios::sync_with_stdio(false);
+        // Untied, so getline on this thread never flushes cout behind the
+        // sink's lock while workers are writing responses
+        std::cin.tie(nullptr);
+        auto sink = std::make_shared<ResultSink>();
+        std::string line;
+        while (std::getline(std::cin, line))
+            submitLine(server, line, sink);
+    } else {
+#if !defined(_WIN32)
+        rc = serveSocket(server, options.socketPath);
+#else
+        std::cerr << "Error: Unix domain sockets are not supported on this platform\n";
+        rc = 1;
+#endif
+    }
+
+    server.finish();
+    server.printStats();
+    return rc;
+}
+
+// ======================================================
+// Load generator
+// ======================================================
+int runLoadGenerator(const LoadGenOptions& options) {
+    std::mt19937 gen(options.seed);
+    std::uniform_int_distribution<> dist(1, 100);
+
+    std::string payload;
+    for (int r = 0; r < options.requests; ++r) {
+        payload += "{\"id\":" + std::to_string(r + 1) +
+                   ",\"algo\":" + jsonQuote(options.algo) +
+                   ",\"order\":false,\"durations\":[";
+        for (int i = 0; i < options.size; ++i) {
+            if (i) payload.push_back(',');
+            payload += std::to_string(dist(gen));
+        }
+        payload += "]}\n";
+    }
+
+    if (options.socketPath.empty()) {
+        std::cout << payload;
+        std::cout.flush();
+        return 0;
+    }
+
+#if !defined(_WIN32)
+    sockaddr_un addr{};
+    if (options.socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: socket path too long: " << options.socketPath << "\n";
+        return 1;
+    }
+    addr.sun_family = AF_UNIX;
+    options.socketPath.copy(addr.sun_path, options.socketPath.size());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::cerr << "Error: cannot connect to " << options.socketPath << "\n";
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread sender([&] {
+        std::size_t off = 0;
+        while (off < payload.size()) {
+            ssize_t w = send(fd, payload.data() + off, payload.size() - off, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) break;
+            off += (std::size_t)w;
+        }
+        shutdown(fd, SHUT_WR);
+    });
+
+    long long responses = 0, errors = 0;
+    std::string buf;
+    char chunk[1 << 16];
+    ssize_t r;
+    while ((r = read(fd, chunk, sizeof(chunk))) != 0) {
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        buf.append(chunk, (std::size_t)r);
+        std::size_t start = 0, nl;
+        while ((nl = buf.find('\n', start)) != std::string::npos) {
+            ++responses;
+            if (std::string_view(buf).substr(start, nl - start).find("\"error\"") != std::string_view::npos)
+                ++errors;
+            start = nl + 1;
+        }
+        buf.erase(0, start);
+    }
+    sender.join();
+    close(fd);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "[loadgen] " << options.requests << " requests (n=" << options.size
+              << ", algo=" << options.algo << "), " << responses << " responses, "
+              << errors << " errors in " << (long long)ms << " ms";
+    if (ms > 0) std::cout << " -> " << (long long)(responses * 1000.0 / ms) << " req/s";
+    std::cout << "\n";
+    return responses == options.requests ? 0 : 1;
+#else
+    std::cerr << "Error: Unix domain sockets are not supported on this platform\n";
+    return 1;
+#endif
+}
@@ -0,0 +1,54 @@
+#include "worker_pool.h"
+
+WorkerPool& WorkerPool::local() {
+    thread_local WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::scoped_lock lock(mtx);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& th : helpers) th.join();
+}
+
+void WorkerPool::dispatch(int workers, void* fnCtx, Call fnCall) {
+    {
+        std::scoped_lock lock(mtx);
+        while ((int)helpers.size() < workers - 1) {
+            int w = (int)helpers.size() + 1;
+            helpers.emplace_back([this, w] { helperLoop(w); });
+        }
+        ctx = fnCtx;
+        call = fnCall;
+        active = workers;
+        pending = workers - 1;
+        ++epoch;
+    }
+    wake.notify_all();
+
+    fnCall(fnCtx, 0);
+
+    std::unique_lock lock(mtx);
+    idle.wait(lock, [this] { return pending == 0; });
+}
+
+void WorkerPool::helperLoop(int w) {
+    std::uint64_t seen = 0;
+    std::unique_lock lock(mtx);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || epoch != seen; });
+        if (stopping) return;
+        seen = epoch;
+        if (w >= active) continue;
+
+        void* c = ctx;
+        Call f = call;
+        lock.unlock();
+        f(c, w);
+        lock.lock();
+        if (--pending == 0) idle.notify_one();
+    }
+}